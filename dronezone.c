@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 #include <SDL2/SDL.h>
@@ -26,6 +27,39 @@
 #define SEPARATION_FACTOR 0.1
 #define SEPARATION_DISTANCE 25
 #define MAX_CIRCLES 10
+#define FLOW_CELL 20                      // Flow field cell size in pixels
+#define FLOW_COLS (WIDTH / FLOW_CELL)
+#define FLOW_ROWS (HEIGHT / FLOW_CELL)
+#define HUNT_WEIGHT 0.3f
+#define EXPORT_POOL_SIZE 8                // Frame buffers in flight between render and writer
+#define EXPORT_SECONDS 60                 // Default clip length for --export
+#define MAX_PARTICLES 50000
+#define LOD_NEAR_RADIUS 150.0f            // Full-rate band
+#define LOD_MID_RADIUS 350.0f
+#define LOD_MID_INTERVAL 2                // Mid band updates every 2nd tick
+#define LOD_FAR_INTERVAL 4                // Far band updates every 4th tick
+#define LOD_LISTS (1 + LOD_MID_INTERVAL + LOD_FAR_INTERVAL)  // Near list, then one list per mid/far phase
+#define BROADPHASE_CELL 25                // Matches SEPARATION_RADIUS
+#define BROADPHASE_COLS (WIDTH / BROADPHASE_CELL + 1)
+#define BROADPHASE_ROWS (HEIGHT / BROADPHASE_CELL + 1)
+#define PLANT_STEM_RADIUS 4.0f            // Stems are a stack of small circles...
+#define PLANT_STEM_SPACING 8              // ...this far apart
+#define PLANT_STEM_BODIES 9               // Enough for the tallest (69px) stem
+#define MAX_BODIES (NUM_DRONES + MAX_CIRCLES + MAX_PLANTS * PLANT_STEM_BODIES)
+#define BROADPHASE_MAX_RADIUS 10.0f       // Largest body radius (a flower)
+#define BROADPHASE_MAX_MOTION (MAX_SPEED + 1.0f)  // Furthest a drone that can reach the player moves in a tick
+#define PLAYER_RADIUS 5.0f
+#define DRONE_RADIUS 5.0f
+#define DRONE_HIT_DAMAGE 5                // Health lost when a drone first touches the player
+#define DRONE_STAY_DAMAGE_TICKS 6         // Then 1 health per this many ticks of contact
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+#define PARTICLE_DRAG 0.96f
+#define POLLEN_PER_FLOWER 120
+#define SPARKS_PER_HIT 6
 
 
 typedef struct {
@@ -46,7 +80,8 @@ typedef struct {
     int isVisible;
     int alpha;
     int isBloomed;
-    Uint32 lastAppearanceTime;} Flower;
+    Uint32 lastAppearanceTime;
+    Uint32 id;} Flower;
 
 typedef struct {
     float x, y;          // Position of the plant base
@@ -58,15 +93,122 @@ typedef struct {
     int type;            // 0 = Grass, 1 = Vine, 2 = Fern
     int alpha;
     int isVisible;
-    int height;} Plant;
+    int height;
+    Uint32 id;} Plant;
+
+typedef struct {
+    int dist[FLOW_ROWS][FLOW_COLS];      // BFS steps to the player's cell, -1 if unreachable
+    float dirX[FLOW_ROWS][FLOW_COLS];    // Unit steering vector toward the next cell
+    float dirY[FLOW_ROWS][FLOW_COLS];
+    Uint8 blocked[FLOW_ROWS][FLOW_COLS]; // Cells covered by flowers or plants
+    int playerCol, playerRow;            // Player cell the field was built for
+    Uint32 obstacleGeneration;           // Obstacle layout the field was built against
+    int valid;} FlowField;
+
+typedef struct {
+    int active;
+    int frame, numFrames;
+    FILE *out;
+    SDL_Texture *target;               // Offscreen render target
+    Uint8 *pixels[EXPORT_POOL_SIZE];   // Reusable RGBA readback buffers
+    int freeBuffers[EXPORT_POOL_SIZE]; // Stack of buffers the renderer may fill
+    int numFree;
+    int queue[EXPORT_POOL_SIZE];       // Ring of filled buffers waiting for the writer
+    int queueHead, queueCount;
+    int done;                          // No more frames will be queued
+    int failed;                        // Readback or writing failed; stop exporting
+    SDL_mutex *lock;
+    SDL_cond *frameQueued;             // Signals the writer
+    SDL_cond *bufferFreed;             // Signals the renderer (back-pressure)
+    SDL_Thread *writer;} Exporter;
+
+// Particle pool stored as structure-of-arrays so the update loop vectorizes.
+// Live particles are always packed into [0, count).
+typedef struct {
+    float x[MAX_PARTICLES], y[MAX_PARTICLES];
+    float vx[MAX_PARTICLES], vy[MAX_PARTICLES];
+    float gravity[MAX_PARTICLES];      // Added to vy every tick (negative floats up)
+    float life[MAX_PARTICLES];         // Ticks left to live
+    float maxLife[MAX_PARTICLES];
+    float size[MAX_PARTICLES];         // Half width of the quad in pixels
+    SDL_Color color[MAX_PARTICLES];
+    int count;} ParticlePool;
+
+// Counter-based random streams. Every value is a pure function of
+// (seed, stream, entity, tick, draw), so it doesn't matter which thread or
+// frame asks for it. Simulation streams must never be drawn from while rendering.
+enum {
+    RNG_DRONES,          // Simulation: per drone at init
+    RNG_PLANTS,          // Simulation: per spawned plant
+    RNG_PLANT_ROLL,      // Simulation: per tick plant spawn chance
+    RNG_FLOWERS,         // Simulation: per spawned flower
+    RNG_FLOWER_WAVE,     // Simulation: per flower spawn wave
+    RNG_BACKGROUND = 0x100,  // Cosmetic: per rendered frame
+    RNG_PLANT_SWAY,      // Cosmetic: per plant and rendered frame
+    RNG_FLOWER_BLOOM,    // Cosmetic: per flower bloom animation
+    RNG_PARTICLES        // Cosmetic: per particle burst
+};
+
+typedef struct {
+    Uint32 stream, entity, tick;
+    Uint32 draw;         // Index of the next value in this sequence
+    Uint32 block[4];     // Last Philox output block, holds draws (draw & ~3) .. +3
+} Rng;
+
+// Anything the player can touch, as stored in the broadphase grid
+enum { CONTACT_DRONE, CONTACT_FLOWER, CONTACT_PLANT };
+
+typedef struct {
+    float x, y;          // Position when the grid was built (start of the tick)
+    float radius;
+    int kind;            // CONTACT_DRONE, CONTACT_FLOWER or CONTACT_PLANT
+    int index;           // Index into drones, flowers or plants
+    Uint32 id;           // Stable across ticks, unlike flower/plant indices
+} Body;
+
+enum { CONTACT_ENTER, CONTACT_STAY, CONTACT_EXIT };
+
+typedef struct {
+    int kind;
+    Uint32 id;
+    int index;           // Only valid for CONTACT_ENTER and CONTACT_STAY
+    int phase;
+    Uint32 ticks;        // Ticks the contact has lasted, 0 on enter
+} ContactEvent;
+
+// Profiling sections, reported once per second with --profile
+enum { PROFILE_FRAME, PROFILE_DRONES, PROFILE_COLLISIONS, PROFILE_PARTICLES, PROFILE_PARTICLE_DRAW, PROFILE_COUNT };
 
 
 Uint32 lastCircleSpawnTime = 0;
 
 Drone player;
 Drone drones[NUM_DRONES];
+int droneBand[NUM_DRONES];     // LOD band: 0 = near, 1 = mid, 2 = far
+int lodList[LOD_LISTS][NUM_DRONES];  // Drones due together: near, mid phases, far phases
+int lodCount[LOD_LISTS];
+int droneList[NUM_DRONES];     // Which LOD list a drone is in, and where
+int droneSlot[NUM_DRONES];
+Uint32 droneLastTick[NUM_DRONES];                  // Tick of each drone's latest update
+float droneStartX[NUM_DRONES], droneStartY[NUM_DRONES];  // Position before that update
+double swarmSumX, swarmSumY, swarmSumVx, swarmSumVy;     // Kept up to date as drones move
+float playerPrevX, playerPrevY;  // Player position at the start of the tick
+Body bodies[MAX_BODIES];       // Drones are bodies [0, NUM_DRONES), flowers and plants follow
+int numBodies = 0;
+int cellHead[BROADPHASE_COLS * BROADPHASE_ROWS];  // First body in each cell, -1 if empty
+int bodyNext[MAX_BODIES], bodyPrev[MAX_BODIES], bodyCell[MAX_BODIES];
+ContactEvent contacts[MAX_BODIES];           // Contacts touching at the end of the last tick
+int numContacts = 0;
+ContactEvent contactEvents[MAX_BODIES * 2];  // Enter/stay/exit events for this tick
+int numContactEvents = 0;
+Uint32 simTick = 0;
 Flower flowers[MAX_CIRCLES];
 Plant plants[MAX_PLANTS];
+FlowField flowField;
+Exporter exporter;
+ParticlePool particles;
+SDL_Vertex particleVertices[MAX_PARTICLES * 4];
+int particleIndices[MAX_PARTICLES * 6];
 
 SDL_Window *window = NULL;
 SDL_Renderer *renderer = NULL;
@@ -81,7 +223,25 @@ int score = 0;
 int highScore = 0;
 int numFlowers = 0;
 int numPlants = 0;
+Uint32 obstacleGeneration = 0;  // Bumped whenever flowers or plants change shape on the flow field
 int grayProgress = 0;
+int huntMode = 0;     // Drones steer toward the player along the flow field
+int useSeed = 0;
+unsigned int gameSeed = 0;
+int profileMode = 0;
+int stressParticles = 0;     // Keep the particle pool full, for profiling
+Uint32 rngSeed = 0;          // Seed for the current round
+Uint32 renderFrame = 0;      // Cosmetic frame counter, separate from simTick
+Uint32 plantSerial = 0;      // Entity ids for the spawners' random streams
+Uint32 flowerSerial = 0;
+Uint32 flowerWaveSerial = 0;
+Uint32 burstSerial = 0;
+
+const char *profileNames[PROFILE_COUNT] = {"frame", "drones", "collisions", "particles", "particle draw"};
+Uint64 profileStart[PROFILE_COUNT];
+Uint64 profileTotal[PROFILE_COUNT];
+int profileFrames = 0;
+Uint32 lastProfileReport = 0;
 
 // Define honey-colored palette
 SDL_Color honeyPrimary = {255, 186, 77, 255};  // Warm golden
@@ -98,6 +258,113 @@ Button backButton = {{10, HEIGHT - 50, 100, 40}, {255, 255, 255, 255}, {200, 200
 Button menuButton = {{WIDTH - 110, HEIGHT - 50, 100, 40}, {255, 255, 255, 255}, {200, 200, 200, 255}, {100, 100, 100, 255}, 0, 0};
 Button exitButton = {{WIDTH / 2 - 50, 300, 100, 40}, {255, 255, 255, 255}, {200, 200, 200, 255}, {100, 100, 100, 255}, 0, 0};
 
+// Game clock in milliseconds; runs off the frame counter while exporting
+// so the simulation doesn't depend on how fast frames are encoded
+Uint32 gameTicks() {
+    if (exporter.active) {
+        return (Uint32)((Uint64)exporter.frame * 1000 / FPS);
+    }
+    return SDL_GetTicks();
+}
+
+// Present an intermediate animation step; skipped while exporting so the
+// encoder isn't throttled by real-time delays
+void animationFrame() {
+    if (exporter.active) return;
+    SDL_RenderPresent(renderer);
+    SDL_Delay(10);
+}
+
+void profileBegin(int section) {
+    profileStart[section] = SDL_GetPerformanceCounter();
+}
+
+void profileEnd(int section) {
+    profileTotal[section] += SDL_GetPerformanceCounter() - profileStart[section];
+}
+
+// Print the average cost of each section once per second of wall time
+void reportProfile() {
+    if (!profileMode) return;
+    profileFrames++;
+
+    Uint32 now = SDL_GetTicks();
+    if (now - lastProfileReport < 1000) return;
+
+    double msPerCount = 1000.0 / SDL_GetPerformanceFrequency();
+    printf("[profile] %d frames:", profileFrames);
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        printf(" %s %.3fms", profileNames[i], profileTotal[i] * msPerCount / profileFrames);
+        profileTotal[i] = 0;
+    }
+    printf(" | %d particles\n", particles.count);
+
+    profileFrames = 0;
+    lastProfileReport = now;
+}
+
+// Philox4x32-10 block function (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3")
+static inline void philox4x32(Uint32 c0, Uint32 c1, Uint32 c2, Uint32 c3, Uint32 k0, Uint32 k1, Uint32 out[4]) {
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+        Uint64 p0 = (Uint64)PHILOX_M0 * c0;
+        Uint64 p1 = (Uint64)PHILOX_M1 * c2;
+        Uint32 n0 = (Uint32)(p1 >> 32) ^ c1 ^ k0;
+        Uint32 n2 = (Uint32)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (Uint32)p1;
+        c3 = (Uint32)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+// Start the sequence of random values owned by one entity of a stream
+Rng rngStream(Uint32 stream, Uint32 entity, Uint32 tick) {
+    Rng rng = {stream, entity, tick, 0, {0, 0, 0, 0}};
+    return rng;
+}
+
+Uint32 rngNext(Rng *rng) {
+    if ((rng->draw & 3) == 0) {
+        philox4x32(rng->entity, rng->tick, rng->draw >> 2, 0, rngSeed, rng->stream, rng->block);
+    }
+    return rng->block[rng->draw++ & 3];
+}
+
+// Map a raw random value to a uniform integer in [0, n)
+int rngScale(Uint32 value, int n) {
+    return (int)(((Uint64)value * (Uint32)n) >> 32);
+}
+
+// Uniform integer in [0, n)
+int rngInt(Rng *rng, int n) {
+    return rngScale(rngNext(rng), n);
+}
+
+// Uniform float in [0, 1)
+float rngFloat(Rng *rng) {
+    return (rngNext(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Generate Philox block number `block` for `count` consecutive entities at once:
+// out0..out3[i] are values 4 * block .. 4 * block + 3 of entity firstEntity + i,
+// the same values rngNext() would give it. Writing whole blocks to separate
+// arrays keeps the loop free of lane-dependent selects, so GCC inlines
+// philox4x32() and vectorizes it at -O3.
+void rngBulk(Uint32 stream, Uint32 firstEntity, int count, Uint32 tick, Uint32 block,
+             Uint32 *restrict out0, Uint32 *restrict out1, Uint32 *restrict out2, Uint32 *restrict out3) {
+    for (int i = 0; i < count; i++) {
+        Uint32 out[4];
+        philox4x32(firstEntity + i, tick, block, 0, rngSeed, stream, out);
+        out0[i] = out[0];
+        out1[i] = out[1];
+        out2[i] = out[2];
+        out3[i] = out[3];
+    }
+}
+
 // Load high score from file
 void loadHighScore() {
     FILE *file = fopen("highscore.txt", "r");
@@ -141,9 +408,10 @@ void renderBackground() {
     }
 
     // Random tiny flowers in meadows
-    int fx = rand() % WIDTH;
-    int fy = HEIGHT - (rand() % 120 + 30);
-    SDL_Color flowerColor = {rand() % 256, rand() % 256, rand() % 256, 55};
+    Rng rng = rngStream(RNG_BACKGROUND, 0, renderFrame);
+    int fx = rngInt(&rng, WIDTH);
+    int fy = HEIGHT - (rngInt(&rng, 120) + 30);
+    SDL_Color flowerColor = {rngInt(&rng, 256), rngInt(&rng, 256), rngInt(&rng, 256), 55};
     filledCircleRGBA(renderer, fx, fy, 2, flowerColor.r, flowerColor.g, flowerColor.b, 55);
     
 }
@@ -151,26 +419,29 @@ void renderBackground() {
 void spawnPlants() {
     if (numPlants >= MAX_PLANTS) return; // Prevent overflow
 
-    int x = rand() % WIDTH;
-    int type = rand() % 3;  // Random type: Grass, Vine, or Fern
+    Rng rng = rngStream(RNG_PLANTS, plantSerial, 0);
+    int x = rngInt(&rng, WIDTH);
+    int type = rngInt(&rng, 3);  // Random type: Grass, Vine, or Fern
 
     plants[numPlants].x = x;
     plants[numPlants].y = HEIGHT;  // Always start at the bottom
     plants[numPlants].growth = 0.0f;
-    plants[numPlants].maxHeight = (rand() % 40) + 30;  // 30 to 70 pixels
-    plants[numPlants].spawnTime = SDL_GetTicks();
-    plants[numPlants].lifespan = (rand() % 15000) + 10000; // 10 to 25 sec
+    plants[numPlants].maxHeight = rngInt(&rng, 40) + 30;  // 30 to 70 pixels
+    plants[numPlants].spawnTime = gameTicks();
+    plants[numPlants].lifespan = rngInt(&rng, 15000) + 10000; // 10 to 25 sec
     plants[numPlants].color = (SDL_Color){34, 139, 34, 255}; // Green
     plants[numPlants].type = type;
+    plants[numPlants].id = plantSerial++;
 
     numPlants++;
+    obstacleGeneration++;
 }
 
 void updatePlants() {
     for (int i = 0; i < MAX_PLANTS; i++) {
         if (!plants[i].isVisible) continue;
         
-        Uint32 elapsed = SDL_GetTicks() - plants[i].spawnTime;
+        Uint32 elapsed = gameTicks() - plants[i].spawnTime;
         if (elapsed > 10000) { // Slowly disappear after 10s
             plants[i].color.r = 139;
             plants[i].color.g = 69;
@@ -184,7 +455,7 @@ void updatePlants() {
 }
 
 void renderPlants() {
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = gameTicks();
 
     for (int i = 0; i < numPlants; i++) {
         float progress = (currentTime - plants[i].spawnTime) / (float)plants[i].lifespan;
@@ -198,6 +469,7 @@ void renderPlants() {
 
         // Calculate growth height
         float height = plants[i].growth * plants[i].maxHeight;
+        Rng sway = rngStream(RNG_PLANT_SWAY, plants[i].id, renderFrame);
         SDL_SetRenderDrawColor(renderer, plants[i].color.r, plants[i].color.g, plants[i].color.b, plants[i].color.a);
 
         if (plants[i].type == 0) {
@@ -206,81 +478,89 @@ void renderPlants() {
         } else if (plants[i].type == 1) {
             // Vine (slightly curving line)
             for (int y = 0; y < height; y += 4) {
-                SDL_RenderDrawPoint(renderer, plants[i].x + (rand() % 3 - 1), HEIGHT - y);
+                SDL_RenderDrawPoint(renderer, plants[i].x + (rngInt(&sway, 3) - 1), HEIGHT - y);
             }
         } else {
             // Fern (small diagonal lines)
             for (int y = 0; y < height; y += 5) {
-                SDL_RenderDrawLine(renderer, plants[i].x, HEIGHT - y, plants[i].x + (rand() % 8 - 4), HEIGHT - y - 3);
+                SDL_RenderDrawLine(renderer, plants[i].x, HEIGHT - y, plants[i].x + (rngInt(&sway, 8) - 4), HEIGHT - y - 3);
             }
         }
 
-        // Update growth
+        // Update growth; the flow field only cares once the stem reaches a new cell row
         if (plants[i].growth < 1.0f) {
+            int topRow = (int)((HEIGHT - height) / FLOW_CELL);
             plants[i].growth += 0.01f;
+            if ((int)((HEIGHT - plants[i].growth * plants[i].maxHeight) / FLOW_CELL) != topRow) {
+                obstacleGeneration++;
+            }
         }
 
         // Remove expired plants
         if (progress >= 1.0f) {
             plants[i] = plants[numPlants - 1]; // Replace with last plant
             numPlants--;
+            obstacleGeneration++;
             i--;
         }
     }
 }
 
 void spawnFlowers() {
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = gameTicks();
 
     if (currentTime - lastCircleSpawnTime > 10000) { // Every 10 seconds
         lastCircleSpawnTime = currentTime;
 
-        int numNewCircles = rand() % 3 + 1; // 1 to 3 circles
+        Rng wave = rngStream(RNG_FLOWER_WAVE, flowerWaveSerial++, 0);
+        int numNewCircles = rngInt(&wave, 3) + 1; // 1 to 3 circles
 
         if (numFlowers + numNewCircles > MAX_CIRCLES) {
             numNewCircles = MAX_CIRCLES - numFlowers;
         }
 
         for (int i = 0; i < numNewCircles; i++) {
-            int x = rand() % (WIDTH - 20) + 10;
-            int y = rand() % (HEIGHT - 20) + 10;
+            Uint32 id = flowerSerial++;
+            Rng rng = rngStream(RNG_FLOWERS, id, 0);
+            Rng bloom = rngStream(RNG_FLOWER_BLOOM, id, 0);
+            int x = rngInt(&rng, WIDTH - 20) + 10;
+            int y = rngInt(&rng, HEIGHT - 20) + 10;
             
             // Grow stem animation
             for (int h = HEIGHT; h > y; h -= 5) {
                 SDL_SetRenderDrawColor(renderer, 34, 139, 34, 255);
                 SDL_RenderDrawLine(renderer, x, h, x, h - 5);
-                SDL_RenderPresent(renderer);
-                SDL_Delay(10);
+                animationFrame();
             }
             
             // Grow green bud
             int budRadius = 2;
             while (budRadius < 10) {
                 filledCircleRGBA(renderer, x, y, budRadius, 34, 139, 34, 255);
-                SDL_RenderPresent(renderer);
-                SDL_Delay(10);
+                animationFrame();
                 budRadius++;
             }
             
             // Blooming animation
-            SDL_Color petalColor = {rand() % 256, rand() % 256, rand() % 256, 255};
+            SDL_Color petalColor = {rngInt(&bloom, 256), rngInt(&bloom, 256), rngInt(&bloom, 256), 255};
             for (int p = 0; p < 360; p += 45) {
                 int petalX = x + cos(p * M_PI / 180) * 12;
                 int petalY = y + sin(p * M_PI / 180) * 12;
-                filledEllipseRGBA(renderer, petalX, petalY, rand() % 8 + 5, rand() % 6 + 4, petalColor.r, petalColor.g, petalColor.b, 255);
-                SDL_RenderPresent(renderer);
-                SDL_Delay(10);
+                filledEllipseRGBA(renderer, petalX, petalY, rngInt(&bloom, 8) + 5, rngInt(&bloom, 6) + 4, petalColor.r, petalColor.g, petalColor.b, 255);
+                animationFrame();
             }
             
             // Assign final bloom properties
             flowers[numFlowers].x = x;
             flowers[numFlowers].y = y;
             flowers[numFlowers].radius = 10;
-            flowers[numFlowers].color = (SDL_Color){rand() % 100 + 100, rand() % 80 + 60, rand() % 60 + 40, 255}; // Earthy tones
+            flowers[numFlowers].color = (SDL_Color){rngInt(&rng, 100) + 100, rngInt(&rng, 80) + 60, rngInt(&rng, 60) + 40, 255}; // Earthy tones
             flowers[numFlowers].isVisible = 1;
             flowers[numFlowers].alpha = 255;
             flowers[numFlowers].lastAppearanceTime = currentTime;
+            flowers[numFlowers].id = id;
             numFlowers++;
+            obstacleGeneration++;
         }
     }
 }
@@ -330,9 +610,219 @@ void drawBee(SDL_Renderer *renderer, float x, float y, float vx, float vy, int i
     }
 }
 
+// Add a particle in O(1); silently dropped when the pool is full
+void spawnParticle(float x, float y, float vx, float vy, float gravity, float life, float size, SDL_Color color) {
+    if (particles.count >= MAX_PARTICLES) return;
+
+    int i = particles.count++;
+    particles.x[i] = x;
+    particles.y[i] = y;
+    particles.vx[i] = vx;
+    particles.vy[i] = vy;
+    particles.gravity[i] = gravity;
+    particles.life[i] = life;
+    particles.maxLife[i] = life;
+    particles.size[i] = size;
+    particles.color[i] = color;
+}
+
+// Remove a particle by moving the last live one into its slot
+void removeParticle(int i) {
+    int last = --particles.count;
+    particles.x[i] = particles.x[last];
+    particles.y[i] = particles.y[last];
+    particles.vx[i] = particles.vx[last];
+    particles.vy[i] = particles.vy[last];
+    particles.gravity[i] = particles.gravity[last];
+    particles.life[i] = particles.life[last];
+    particles.maxLife[i] = particles.maxLife[last];
+    particles.size[i] = particles.size[last];
+    particles.color[i] = particles.color[last];
+}
+
+// Pollen drifting up out of a collected flower
+void spawnPollenBurst(float x, float y, SDL_Color color) {
+    Rng rng = rngStream(RNG_PARTICLES, burstSerial++, 0);
+    for (int i = 0; i < POLLEN_PER_FLOWER; i++) {
+        float angle = rngFloat(&rng) * 2 * M_PI;
+        float speed = rngFloat(&rng) * 2.5f;
+        SDL_Color tint = (i % 3 == 0) ? color : honeyHighlight;
+        spawnParticle(x, y, cos(angle) * speed, sin(angle) * speed, -0.02f, 40 + rngInt(&rng, 40), 1.5f, tint);
+    }
+}
+
+// Short-lived sparks where a drone hits the player
+void spawnSparks(float x, float y) {
+    Rng rng = rngStream(RNG_PARTICLES, burstSerial++, 0);
+    for (int i = 0; i < SPARKS_PER_HIT; i++) {
+        float angle = rngFloat(&rng) * 2 * M_PI;
+        float speed = 2 + rngFloat(&rng) * 4;
+        SDL_Color color = {255, 120 + rngInt(&rng, 100), 0, 255};
+        spawnParticle(x, y, cos(angle) * speed, sin(angle) * speed, 0.15f, 10 + rngInt(&rng, 15), 1.0f, color);
+    }
+}
+
+// Top the pool back up to MAX_PARTICLES with pollen bursts all over the screen
+void fillParticlePool() {
+    while (particles.count < MAX_PARTICLES) {
+        Rng rng = rngStream(RNG_PARTICLES, burstSerial, 1);
+        spawnPollenBurst(rngInt(&rng, WIDTH), rngInt(&rng, HEIGHT), honeyPrimary);
+    }
+}
+
+void updateParticles() {
+    int count = particles.count;
+    float *restrict x = particles.x, *restrict y = particles.y;
+    float *restrict vx = particles.vx, *restrict vy = particles.vy;
+    const float *restrict gravity = particles.gravity;
+    float *restrict life = particles.life;
+
+    // Branch-free integration over the packed arrays
+    for (int i = 0; i < count; i++) {
+        x[i] += vx[i];
+        y[i] += vy[i];
+        vx[i] *= PARTICLE_DRAG;
+        vy[i] = vy[i] * PARTICLE_DRAG + gravity[i];
+        life[i] -= 1.0f;
+    }
+
+    for (int i = 0; i < particles.count; ) {
+        if (particles.life[i] <= 0) {
+            removeParticle(i);  // Re-check the particle swapped into slot i
+        } else {
+            i++;
+        }
+    }
+}
+
+// Draw every live particle as a fading quad with a single SDL_RenderGeometry call
+void renderParticles() {
+    static int indicesReady = 0;
+    if (!indicesReady) {
+        for (int i = 0; i < MAX_PARTICLES; i++) {
+            int *idx = &particleIndices[i * 6];
+            idx[0] = i * 4; idx[1] = i * 4 + 1; idx[2] = i * 4 + 2;
+            idx[3] = i * 4; idx[4] = i * 4 + 2; idx[5] = i * 4 + 3;
+        }
+        indicesReady = 1;
+    }
+    if (particles.count == 0) return;
+
+    for (int i = 0; i < particles.count; i++) {
+        float s = particles.size[i];
+        SDL_Color color = particles.color[i];
+        color.a = (Uint8)(255 * particles.life[i] / particles.maxLife[i]);
+
+        SDL_Vertex *v = &particleVertices[i * 4];
+        v[0].position = (SDL_FPoint){particles.x[i] - s, particles.y[i] - s};
+        v[1].position = (SDL_FPoint){particles.x[i] + s, particles.y[i] - s};
+        v[2].position = (SDL_FPoint){particles.x[i] + s, particles.y[i] + s};
+        v[3].position = (SDL_FPoint){particles.x[i] - s, particles.y[i] + s};
+        v[0].color = v[1].color = v[2].color = v[3].color = color;
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_RenderGeometry(renderer, NULL, particleVertices, particles.count * 4, particleIndices, particles.count * 6);
+}
+
+int droneBandFor(float x, float y) {
+    float dx = x - player.x;
+    float dy = y - player.y;
+    float distSq = dx * dx + dy * dy;
+
+    if (distSq < LOD_NEAR_RADIUS * LOD_NEAR_RADIUS) return 0;
+    if (distSq < LOD_MID_RADIUS * LOD_MID_RADIUS) return 1;
+    return 2;
+}
+
+// Put a drone into the list for its band. Mid and far drones are spread over
+// the band's phases by index so each tick gets an even share of them.
+void placeDrone(int i, int band) {
+    int list = 0;
+    if (band == 1) list = 1 + (simTick + i) % LOD_MID_INTERVAL;
+    if (band == 2) list = 1 + LOD_MID_INTERVAL + (simTick + i) % LOD_FAR_INTERVAL;
+
+    droneBand[i] = band;
+    droneList[i] = list;
+    droneSlot[i] = lodCount[list];
+    lodList[list][lodCount[list]++] = i;
+}
+
+// Swap-remove a drone from its LOD list
+void unplaceDrone(int i) {
+    int list = droneList[i];
+    int last = lodList[list][--lodCount[list]];
+    lodList[list][droneSlot[i]] = last;
+    droneSlot[last] = droneSlot[i];
+}
+
+int broadphaseCell(float x, float y) {
+    int c = (int)(x / BROADPHASE_CELL);
+    int r = (int)(y / BROADPHASE_CELL);
+    if (c < 0) c = 0;
+    if (c >= BROADPHASE_COLS) c = BROADPHASE_COLS - 1;
+    if (r < 0) r = 0;
+    if (r >= BROADPHASE_ROWS) r = BROADPHASE_ROWS - 1;
+    return r * BROADPHASE_COLS + c;
+}
+
+// Broadphase cells are doubly linked lists, so a body moves between cells in O(1)
+void linkBody(int b) {
+    int cell = broadphaseCell(bodies[b].x, bodies[b].y);
+    bodyCell[b] = cell;
+    bodyPrev[b] = -1;
+    bodyNext[b] = cellHead[cell];
+    if (cellHead[cell] >= 0) bodyPrev[cellHead[cell]] = b;
+    cellHead[cell] = b;
+}
+
+void unlinkBody(int b) {
+    if (bodyPrev[b] >= 0) bodyNext[bodyPrev[b]] = bodyNext[b];
+    else cellHead[bodyCell[b]] = bodyNext[b];
+    if (bodyNext[b] >= 0) bodyPrev[bodyNext[b]] = bodyPrev[b];
+}
+
+// Sync a drone's body with its position, relinking only if it changed cell
+void moveDroneBody(int i) {
+    bodies[i].x = drones[i].x;
+    bodies[i].y = drones[i].y;
+    if (broadphaseCell(drones[i].x, drones[i].y) != bodyCell[i]) {
+        unlinkBody(i);
+        linkBody(i);
+    }
+}
+
+// Full reset of the LOD lists, swarm sums and drone bodies for a new round
+void resetDroneLod() {
+    for (int l = 0; l < LOD_LISTS; l++) {
+        lodCount[l] = 0;
+    }
+    for (int c = 0; c < BROADPHASE_COLS * BROADPHASE_ROWS; c++) {
+        cellHead[c] = -1;
+    }
+    numBodies = NUM_DRONES;
+
+    swarmSumX = swarmSumY = swarmSumVx = swarmSumVy = 0;
+    for (int i = 0; i < NUM_DRONES; i++) {
+        placeDrone(i, droneBandFor(drones[i].x, drones[i].y));
+        droneLastTick[i] = simTick;
+        droneStartX[i] = drones[i].x;
+        droneStartY[i] = drones[i].y;
+        swarmSumX += drones[i].x;
+        swarmSumY += drones[i].y;
+        swarmSumVx += drones[i].vx;
+        swarmSumVy += drones[i].vy;
+
+        bodies[i] = (Body){drones[i].x, drones[i].y, DRONE_RADIUS, CONTACT_DRONE, i, i};
+        linkBody(i);
+    }
+}
+
 // Initialize drones and circles
 void initDrones() {
-    srand(time(NULL));
+    rngSeed = useSeed ? gameSeed : (Uint32)time(NULL);
+    plantSerial = flowerSerial = flowerWaveSerial = burstSerial = 0;
+    simTick = 0;
     player.x = WIDTH / 2;
     player.y = HEIGHT / 2;
     player.vx = player.vy = 0;
@@ -341,18 +831,30 @@ void initDrones() {
     playerHealth = 100;
     score = 0;
 
+    // One Philox block per drone covers all four of its spawn values
+    static Uint32 spawnX[NUM_DRONES], spawnY[NUM_DRONES], spawnVx[NUM_DRONES], spawnVy[NUM_DRONES];
+    rngBulk(RNG_DRONES, 0, NUM_DRONES, 0, 0, spawnX, spawnY, spawnVx, spawnVy);
+
     for (int i = 0; i < NUM_DRONES; i++) {
-        drones[i].x = rand() % WIDTH;
-        drones[i].y = rand() % HEIGHT;
-        drones[i].vx = (float)(rand() % MAX_SPEED) - MAX_SPEED / 2;
-        drones[i].vy = (float)(rand() % MAX_SPEED) - MAX_SPEED / 2;
+        drones[i].x = rngScale(spawnX[i], WIDTH);
+        drones[i].y = rngScale(spawnY[i], HEIGHT);
+        drones[i].vx = (float)rngScale(spawnVx[i], MAX_SPEED) - MAX_SPEED / 2;
+        drones[i].vy = (float)rngScale(spawnVy[i], MAX_SPEED) - MAX_SPEED / 2;
     }
 
-    // Initialize circles
+    // Initialize circles; plants go too, so new plant ids never collide with survivors
     numFlowers = 0;
+    numPlants = 0;
     for (int i = 0; i < MAX_CIRCLES; i++) {
         flowers[i].isVisible = 0;  // Initially not visible
     }
+
+    resetDroneLod();
+    flowField.valid = 0;  // Force a rebuild for the new round
+    particles.count = 0;
+    numContacts = 0;
+    playerPrevX = player.x;
+    playerPrevY = player.y;
 }
 
 // Render text on screen
@@ -365,50 +867,250 @@ void renderText(const char *text, int x, int y, SDL_Color color) {
     SDL_DestroyTexture(texture);
 }
 
-// Update drones based on Boid behavior
+// Convert a pixel coordinate to a clamped flow field cell
+int flowCell(float v, int count) {
+    int c = (int)(v / FLOW_CELL);
+    if (c < 0) c = 0;
+    if (c >= count) c = count - 1;
+    return c;
+}
+
+// Mark the cells a rectangle covers as blocked
+void blockFlowRect(float x0, float y0, float x1, float y1) {
+    int c0 = flowCell(x0, FLOW_COLS), c1 = flowCell(x1, FLOW_COLS);
+    int r0 = flowCell(y0, FLOW_ROWS), r1 = flowCell(y1, FLOW_ROWS);
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            flowField.blocked[r][c] = 1;
+        }
+    }
+}
+
+// Rasterize flowers and plants into the obstacle grid
+void markFlowObstacles() {
+    for (int r = 0; r < FLOW_ROWS; r++) {
+        for (int c = 0; c < FLOW_COLS; c++) {
+            flowField.blocked[r][c] = 0;
+        }
+    }
+
+    for (int i = 0; i < numFlowers; i++) {
+        float reach = flowers[i].radius + 2;
+        blockFlowRect(flowers[i].x - reach, flowers[i].y - reach, flowers[i].x + reach, flowers[i].y + reach);
+    }
+
+    for (int i = 0; i < numPlants; i++) {
+        float height = plants[i].growth * plants[i].maxHeight;
+        blockFlowRect(plants[i].x - 4, HEIGHT - height, plants[i].x + 4, HEIGHT - 1);
+    }
+}
+
+// Rebuild the flow field toward the player with a BFS over the grid.
+// Only runs when the player changes cell or the obstacle layout changes,
+// so the cost is independent of how many drones sample it.
+void updateFlowField() {
+    int playerCol = flowCell(player.x, FLOW_COLS);
+    int playerRow = flowCell(player.y, FLOW_ROWS);
+
+    if (flowField.valid && flowField.playerCol == playerCol && flowField.playerRow == playerRow &&
+        flowField.obstacleGeneration == obstacleGeneration) {
+        return;
+    }
+
+    markFlowObstacles();
+
+    static int queue[FLOW_ROWS * FLOW_COLS];
+    int head = 0, tail = 0;
+    for (int r = 0; r < FLOW_ROWS; r++) {
+        for (int c = 0; c < FLOW_COLS; c++) {
+            flowField.dist[r][c] = -1;
+        }
+    }
+
+    // The player's own cell is always the goal, even if it overlaps an obstacle
+    flowField.dist[playerRow][playerCol] = 0;
+    queue[tail++] = playerRow * FLOW_COLS + playerCol;
+
+    const int stepC[4] = {1, -1, 0, 0};
+    const int stepR[4] = {0, 0, 1, -1};
+    while (head < tail) {
+        int cell = queue[head++];
+        int r = cell / FLOW_COLS, c = cell % FLOW_COLS;
+        for (int k = 0; k < 4; k++) {
+            int nr = r + stepR[k], nc = c + stepC[k];
+            if (nr < 0 || nr >= FLOW_ROWS || nc < 0 || nc >= FLOW_COLS) continue;
+            if (flowField.blocked[nr][nc] || flowField.dist[nr][nc] >= 0) continue;
+            flowField.dist[nr][nc] = flowField.dist[r][c] + 1;
+            queue[tail++] = nr * FLOW_COLS + nc;
+        }
+    }
+
+    // Point every reachable cell at its closest neighbour (8-way for smoother paths)
+    for (int r = 0; r < FLOW_ROWS; r++) {
+        for (int c = 0; c < FLOW_COLS; c++) {
+            flowField.dirX[r][c] = 0;
+            flowField.dirY[r][c] = 0;
+            int best = flowField.dist[r][c];
+            if (best <= 0) continue;
+
+            for (int dr = -1; dr <= 1; dr++) {
+                for (int dc = -1; dc <= 1; dc++) {
+                    int nr = r + dr, nc = c + dc;
+                    if (nr < 0 || nr >= FLOW_ROWS || nc < 0 || nc >= FLOW_COLS) continue;
+                    int d = flowField.dist[nr][nc];
+                    if (d < 0 || d >= best) continue;
+                    // Don't cut corners around obstacles on diagonal moves
+                    if (dr != 0 && dc != 0 && (flowField.blocked[r][nc] || flowField.blocked[nr][c])) continue;
+                    best = d;
+                    float len = (dr != 0 && dc != 0) ? (float)M_SQRT1_2 : 1.0f;
+                    flowField.dirX[r][c] = dc * len;
+                    flowField.dirY[r][c] = dr * len;
+                }
+            }
+        }
+    }
+
+    flowField.playerCol = playerCol;
+    flowField.playerRow = playerRow;
+    flowField.obstacleGeneration = obstacleGeneration;
+    flowField.valid = 1;
+}
+
+// Look up the steering direction for a position in O(1)
+void sampleFlowField(float x, float y, float *fx, float *fy) {
+    int c = flowCell(x, FLOW_COLS);
+    int r = flowCell(y, FLOW_ROWS);
+
+    if (flowField.dist[r][c] > 0) {
+        *fx = flowField.dirX[r][c];
+        *fy = flowField.dirY[r][c];
+        return;
+    }
+
+    // In the player's cell (or stuck inside an obstacle): head straight for the player
+    float dx = player.x - x;
+    float dy = player.y - y;
+    float distance = sqrt(dx * dx + dy * dy);
+    if (distance > 0) {
+        *fx = dx / distance;
+        *fy = dy / distance;
+    } else {
+        *fx = *fy = 0;
+    }
+}
+
+void addBody(float x, float y, float radius, int kind, int index, Uint32 id) {
+    bodies[numBodies] = (Body){x, y, radius, kind, index, id};
+    linkBody(numBodies);
+    numBodies++;
+}
+
+// Drones, flowers and plants share one uniform grid. Drone separation and
+// player contacts both query it, so a lookup only touches the few cells
+// around the point of interest. Drones relink themselves as they move; the
+// flowers and plants are re-added each tick, which costs O(flowers + plants).
+void rebuildStaticBodies() {
+    for (int b = NUM_DRONES; b < numBodies; b++) {
+        unlinkBody(b);
+    }
+    numBodies = NUM_DRONES;
+
+    for (int i = 0; i < numFlowers; i++) {
+        addBody(flowers[i].x, flowers[i].y, flowers[i].radius, CONTACT_FLOWER, i, flowers[i].id);
+    }
+    for (int i = 0; i < numPlants; i++) {
+        // Cover the stem from the ground up to its current height
+        float height = plants[i].growth * plants[i].maxHeight;
+        int stemBodies = (int)(height / PLANT_STEM_SPACING) + 1;
+        if (stemBodies > PLANT_STEM_BODIES) stemBodies = PLANT_STEM_BODIES;
+        for (int k = 0; k < stemBodies; k++) {
+            addBody(plants[i].x, HEIGHT - k * PLANT_STEM_SPACING, PLANT_STEM_RADIUS, CONTACT_PLANT, i, plants[i].id);
+        }
+    }
+}
+
+// Update drones based on Boid behavior.
+// Drones near the player update every tick; farther bands update every
+// k-th tick with a larger step. Each band is split into per-phase lists, so a
+// tick only visits the near drones plus the one mid and one far phase due now;
+// drones are re-banded only when they update. Per tick that is
+// O(near + mid / LOD_MID_INTERVAL + far / LOD_FAR_INTERVAL + flowers + plants):
+// the far share still grows with the swarm, just LOD_FAR_INTERVAL times slower.
 void updateDrones() {
-    for (int i = 0; i < NUM_DRONES; i++) {
-        float avg_vx = 0, avg_vy = 0;
-        float avg_x = 0, avg_y = 0;
+    if (huntMode) {
+        updateFlowField();
+    }
+    simTick++;
+
+    rebuildStaticBodies();
+
+    // Snapshot who is due, since updating re-bands drones into other lists
+    static int due[NUM_DRONES];
+    int numDue = 0;
+    const int dueLists[3] = {0, 1 + simTick % LOD_MID_INTERVAL, 1 + LOD_MID_INTERVAL + simTick % LOD_FAR_INTERVAL};
+    for (int d = 0; d < 3; d++) {
+        int list = dueLists[d];
+        for (int k = 0; k < lodCount[list]; k++) {
+            due[numDue++] = lodList[list][k];
+        }
+    }
+
+    for (int n = 0; n < numDue; n++) {
+        int i = due[n];
+
+        // Integrate over every tick since the drone's last update
+        Uint32 elapsed = simTick - droneLastTick[i];
+        float step = elapsed < LOD_FAR_INTERVAL ? elapsed : LOD_FAR_INTERVAL;
+        Drone before = drones[i];
+
         float separation_x = 0, separation_y = 0;
-        int neighbors = 0;
-
-        for (int j = 0; j < NUM_DRONES; j++) {
-            if (i == j) continue;
-            float dx = drones[i].x - drones[j].x;
-            float dy = drones[i].y - drones[j].y;
-            float distance = sqrt(dx * dx + dy * dy);
-
-            // Always include every other drone for cohesion and alignment:
-            avg_x += drones[j].x;
-            avg_y += drones[j].y;
-            avg_vx += drones[j].vx;
-            avg_vy += drones[j].vy;
-
-            // Separation: only for drones closer than SEPARATION_RADIUS (now 25.0f)
-            if (distance < SEPARATION_RADIUS) {
-                separation_x += (drones[i].x - drones[j].x);
-                separation_y += (drones[i].y - drones[j].y);
+        int neighbors = NUM_DRONES - 1;
+
+        // Separation: only for drones closer than SEPARATION_RADIUS, found via the grid
+        int cell = broadphaseCell(drones[i].x, drones[i].y);
+        int cellCol = cell % BROADPHASE_COLS, cellRow = cell / BROADPHASE_COLS;
+        for (int r = cellRow - 1; r <= cellRow + 1; r++) {
+            if (r < 0 || r >= BROADPHASE_ROWS) continue;
+            for (int c = cellCol - 1; c <= cellCol + 1; c++) {
+                if (c < 0 || c >= BROADPHASE_COLS) continue;
+                for (int b = cellHead[r * BROADPHASE_COLS + c]; b >= 0; b = bodyNext[b]) {
+                    const Body *body = &bodies[b];
+                    if (body->kind != CONTACT_DRONE) continue;
+                    int j = body->index;
+                    if (i == j) continue;
+                    float dx = drones[i].x - drones[j].x;
+                    float dy = drones[i].y - drones[j].y;
+                    if (dx * dx + dy * dy < SEPARATION_RADIUS * SEPARATION_RADIUS) {
+                        separation_x += dx;
+                        separation_y += dy;
+                    }
+                }
             }
-
-            neighbors++;
         }
 
         if (neighbors > 0) {
-            avg_x /= neighbors;
-            avg_y /= neighbors;
-            avg_vx /= neighbors;
-            avg_vy /= neighbors;
+            float avg_x = (swarmSumX - drones[i].x) / neighbors;
+            float avg_y = (swarmSumY - drones[i].y) / neighbors;
+            float avg_vx = (swarmSumVx - drones[i].vx) / neighbors;
+            float avg_vy = (swarmSumVy - drones[i].vy) / neighbors;
 
             // Apply the forces with the new weights:
-            drones[i].vx += (avg_x - drones[i].x) * COHESION_WEIGHT;
-            drones[i].vy += (avg_y - drones[i].y) * COHESION_WEIGHT;
+            drones[i].vx += (avg_x - drones[i].x) * COHESION_WEIGHT * step;
+            drones[i].vy += (avg_y - drones[i].y) * COHESION_WEIGHT * step;
 
-            drones[i].vx += avg_vx * ALIGNMENT_WEIGHT;
-            drones[i].vy += avg_vy * ALIGNMENT_WEIGHT;
+            drones[i].vx += avg_vx * ALIGNMENT_WEIGHT * step;
+            drones[i].vy += avg_vy * ALIGNMENT_WEIGHT * step;
+
+            drones[i].vx += separation_x * SEPARATION_WEIGHT * step;
+            drones[i].vy += separation_y * SEPARATION_WEIGHT * step;
+        }
 
-            drones[i].vx += separation_x * SEPARATION_WEIGHT;
-            drones[i].vy += separation_y * SEPARATION_WEIGHT;
+        // Hunt: follow the flow field toward the player around obstacles
+        if (huntMode) {
+            float flow_x, flow_y;
+            sampleFlowField(drones[i].x, drones[i].y, &flow_x, &flow_y);
+            drones[i].vx += flow_x * HUNT_WEIGHT * step;
+            drones[i].vy += flow_y * HUNT_WEIGHT * step;
         }
 
         // (Optional) Remove friction to match reference exactly:
@@ -423,8 +1125,8 @@ void updateDrones() {
         }
 
         // Update position and wrap around
-        drones[i].x += drones[i].vx;
-        drones[i].y += drones[i].vy;
+        drones[i].x += drones[i].vx * step;
+        drones[i].y += drones[i].vy * step;
         if (drones[i].x < 0) drones[i].x = WIDTH;
         if (drones[i].x >= WIDTH) drones[i].x = 0;
         if (drones[i].y < 0) drones[i].y = HEIGHT;
@@ -432,14 +1134,32 @@ void updateDrones() {
 
         if (drones[i].vx != 0 || drones[i].vy != 0) {
             float angle = atan2(drones[i].vy, drones[i].vx);
-            drones[i].x += cos(angle) * 0.5; // Minor offset to align movement direction
-            drones[i].y += sin(angle) * 0.5;
+            drones[i].x += cos(angle) * 0.5 * step; // Minor offset to align movement direction
+            drones[i].y += sin(angle) * 0.5 * step;
+        }
+
+        swarmSumX += drones[i].x - before.x;
+        swarmSumY += drones[i].y - before.y;
+        swarmSumVx += drones[i].vx - before.vx;
+        swarmSumVy += drones[i].vy - before.vy;
+        droneStartX[i] = before.x;
+        droneStartY[i] = before.y;
+        droneLastTick[i] = simTick;
+        moveDroneBody(i);
+
+        int band = droneBandFor(drones[i].x, drones[i].y);
+        if (band != droneBand[i]) {
+            unplaceDrone(i);
+            placeDrone(i, band);
         }
     }
 }
 
 // Update player movement (mouse-based)
 void updatePlayer(const Uint8 *keystate, int mouseX, int mouseY) {
+    playerPrevX = player.x;
+    playerPrevY = player.y;
+
     // Calculate direction vector toward the mouse
     float dx = mouseX - player.x;
     float dy = mouseY - player.y;
@@ -472,48 +1192,164 @@ void updatePlayer(const Uint8 *keystate, int mouseX, int mouseY) {
 
 }
 
-// Check for collisions
-void checkCollisions() {
-    for (int i = 0; i < NUM_DRONES; i++) {
-        float dist = sqrt(pow(player.x - drones[i].x, 2) + pow(player.y - drones[i].y, 2));
-        if (dist < 10) {
-            playerHealth -= 1;
-            if (playerHealth <= 0) {
-                gameOver = 1;
-                inGame = 0;
-                if (score > highScore) {
-                    highScore = score;
-                    saveHighScore();
+// Swept circle-vs-circle test over the tick: do two circles moving in straight
+// lines from (a0 -> a1) and (b0 -> b1) come within `reach` of each other?
+// Works on squared distances, so no sqrt is needed.
+int sweptCircleHit(float ax0, float ay0, float ax1, float ay1,
+                   float bx0, float by0, float bx1, float by1, float reach) {
+    float px = ax0 - bx0, py = ay0 - by0;                          // Start offset
+    float dx = (ax1 - ax0) - (bx1 - bx0), dy = (ay1 - ay0) - (by1 - by0);  // Relative motion
+
+    // Time of closest approach, clamped to this tick
+    float t = 0;
+    float motionSq = dx * dx + dy * dy;
+    if (motionSq > 0) {
+        t = -(px * dx + py * dy) / motionSq;
+        if (t < 0) t = 0;
+        if (t > 1) t = 1;
+    }
+
+    float cx = px + dx * t, cy = py + dy * t;
+    return cx * cx + cy * cy < reach * reach;
+}
+
+int compareContacts(const void *a, const void *b) {
+    const ContactEvent *ca = a, *cb = b;
+    if (ca->kind != cb->kind) return ca->kind - cb->kind;
+    return (ca->id > cb->id) - (ca->id < cb->id);
+}
+
+// Find everything the player touched during this tick and diff it against the
+// previous tick's contacts into enter/stay/exit events.
+void findContacts() {
+    static ContactEvent touching[MAX_BODIES];
+    int numTouching = 0;
+
+    // Everything that could reach the player's swept circle this tick. Only
+    // near-band drones can get this close, and they move at most one tick's worth.
+    float reach = PLAYER_RADIUS + BROADPHASE_MAX_RADIUS + BROADPHASE_MAX_MOTION;
+    float minX = fminf(playerPrevX, player.x) - reach, maxX = fmaxf(playerPrevX, player.x) + reach;
+    float minY = fminf(playerPrevY, player.y) - reach, maxY = fmaxf(playerPrevY, player.y) + reach;
+    int first = broadphaseCell(minX, minY), last = broadphaseCell(maxX, maxY);
+
+    for (int r = first / BROADPHASE_COLS; r <= last / BROADPHASE_COLS; r++) {
+        for (int c = first % BROADPHASE_COLS; c <= last % BROADPHASE_COLS; c++) {
+            int n = r * BROADPHASE_COLS + c;
+            for (int b = cellHead[n]; b >= 0; b = bodyNext[b]) {
+                const Body *body = &bodies[b];
+
+                // Only drones move, and only those updated this tick; ignore
+                // the jump when one wraps around the screen
+                float endX = body->x, endY = body->y;
+                float startX = body->x, startY = body->y;
+                if (body->kind == CONTACT_DRONE && droneLastTick[body->index] == simTick) {
+                    startX = droneStartX[body->index];
+                    startY = droneStartY[body->index];
+                    if (fabsf(endX - startX) > WIDTH / 2 || fabsf(endY - startY) > HEIGHT / 2) {
+                        startX = endX;
+                        startY = endY;
+                    }
+                }
+
+                if (sweptCircleHit(playerPrevX, playerPrevY, player.x, player.y,
+                                   startX, startY, endX, endY, PLAYER_RADIUS + body->radius)) {
+                    touching[numTouching++] = (ContactEvent){body->kind, body->id, body->index, CONTACT_STAY, 0};
                 }
             }
         }
     }
+
+    // A plant touched by several of its stem circles is still one contact
+    qsort(touching, numTouching, sizeof(ContactEvent), compareContacts);
+    int unique = 0;
+    for (int k = 0; k < numTouching; k++) {
+        if (unique == 0 || compareContacts(&touching[unique - 1], &touching[k]) != 0) {
+            touching[unique++] = touching[k];
+        }
+    }
+    numTouching = unique;
+
+    // Merge the sorted old and new contact sets
+    numContactEvents = 0;
+    int i = 0, j = 0;
+    while (i < numContacts || j < numTouching) {
+        int order = (i == numContacts) ? 1 : (j == numTouching) ? -1 : compareContacts(&contacts[i], &touching[j]);
+        if (order < 0) {
+            contactEvents[numContactEvents] = contacts[i++];
+            contactEvents[numContactEvents++].phase = CONTACT_EXIT;
+        } else if (order > 0) {
+            touching[j].phase = CONTACT_ENTER;
+            contactEvents[numContactEvents++] = touching[j++];
+        } else {
+            touching[j].ticks = contacts[i++].ticks + 1;
+            contactEvents[numContactEvents++] = touching[j++];
+        }
+    }
+
+    for (int k = 0; k < numTouching; k++) {
+        contacts[k] = touching[k];
+    }
+    numContacts = numTouching;
 }
 
-void checkCircleCollisions() {
-    Uint32 currentTime = SDL_GetTicks();
-    for (int i = 0; i < numFlowers; i++) {
-        // Check for player collection (example: if player is near)
-        int dx = player.x - flowers[i].x;
-        int dy = player.y - flowers[i].y;
-        if (sqrt(dx * dx + dy * dy) < 15) {  // Example: if within 15px
+// Apply this tick's contact events to health and score
+void applyContactEvents() {
+    for (int e = 0; e < numContactEvents; e++) {
+        ContactEvent *event = &contactEvents[e];
+
+        if (event->kind == CONTACT_DRONE) {
+            if (event->phase == CONTACT_ENTER) {
+                playerHealth -= DRONE_HIT_DAMAGE;
+                spawnSparks(player.x, player.y);
+            } else if (event->phase == CONTACT_STAY && event->ticks % DRONE_STAY_DAMAGE_TICKS == 0) {
+                playerHealth -= 1;
+            }
+        } else if (event->kind == CONTACT_FLOWER && event->phase == CONTACT_ENTER) {
+            Flower *flower = &flowers[event->index];
             score += 10;  // Increase score
+            spawnPollenBurst(flower->x, flower->y, flower->color);
+            flower->isVisible = 0;  // Removed below, once no more events refer to indices
+        }
+        // Plant contacts are reported but don't affect the player (yet)
+    }
+
+    for (int i = 0; i < numFlowers; i++) {
+        if (!flowers[i].isVisible) {
             flowers[i] = flowers[numFlowers - 1];  // Remove flower
             numFlowers--;
             i--;
+            obstacleGeneration++;
+        }
+    }
+
+    if (playerHealth <= 0) {
+        gameOver = 1;
+        inGame = 0;
+        if (score > highScore && !exporter.active) {  // A scripted export never touches the player's high score
+            highScore = score;
+            saveHighScore();
         }
     }
 }
 
+// Check for collisions
+void checkCollisions() {
+    findContacts();
+    applyContactEvents();
+}
+
 // Render game
 void renderGame() {
+    profileBegin(PROFILE_FRAME);
+    renderFrame++;
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = gameTicks();
 
     renderBackground();
 
-    if (rand() % 100 < 3) {  // 3% chance every frame
+    Rng roll = rngStream(RNG_PLANT_ROLL, 0, simTick);
+    if (rngInt(&roll, 100) < 3) {  // 3% chance every frame
         spawnPlants();
     }    
     renderPlants();
@@ -546,9 +1382,23 @@ void renderGame() {
         SDL_RenderFillCircle(renderer, flowers[i].x, flowers[i].y, flowers[i].radius);
     }
 
+    profileBegin(PROFILE_DRONES);
     updateDrones();
+    profileEnd(PROFILE_DRONES);
+    profileBegin(PROFILE_COLLISIONS);
+    checkCollisions();
+    profileEnd(PROFILE_COLLISIONS);
     spawnFlowers();
-    checkCircleCollisions();
+
+    profileBegin(PROFILE_PARTICLES);
+    if (stressParticles) {
+        fillParticlePool();
+    }
+    updateParticles();
+    profileEnd(PROFILE_PARTICLES);
+    profileBegin(PROFILE_PARTICLE_DRAW);
+    renderParticles();
+    profileEnd(PROFILE_PARTICLE_DRAW);
 
     // Set the health bar color and render it
     SDL_SetRenderDrawColor(renderer, healthColor.r, healthColor.g, healthColor.b, healthColor.a);
@@ -569,8 +1419,9 @@ void renderGame() {
     sprintf(scoreText, "Score: %d", score);
     renderText(scoreText, WIDTH - 150, 10, (SDL_Color){255, 255, 255, 255});
 
+    profileEnd(PROFILE_FRAME);
     SDL_RenderPresent(renderer);
-    
+    reportProfile();
 }
 
 // Render menu buttons
@@ -733,14 +1584,298 @@ void handleMenuEvents(SDL_Event *e) {
     }
 }
 
+// Convert an RGBA frame to planar YUV 4:2:0 (BT.601, studio range)
+void convertFrameToI420(const Uint8 *rgba, Uint8 *yuv) {
+    Uint8 *yPlane = yuv;
+    Uint8 *uPlane = yuv + WIDTH * HEIGHT;
+    Uint8 *vPlane = uPlane + (WIDTH / 2) * (HEIGHT / 2);
+
+    for (int y = 0; y < HEIGHT; y++) {
+        const Uint8 *row = rgba + y * WIDTH * 4;
+        for (int x = 0; x < WIDTH; x++) {
+            int r = row[x * 4], g = row[x * 4 + 1], b = row[x * 4 + 2];
+            yPlane[y * WIDTH + x] = (Uint8)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        }
+    }
+
+    // Chroma is averaged over each 2x2 block
+    for (int y = 0; y < HEIGHT / 2; y++) {
+        const Uint8 *row0 = rgba + (y * 2) * WIDTH * 4;
+        const Uint8 *row1 = row0 + WIDTH * 4;
+        for (int x = 0; x < WIDTH / 2; x++) {
+            int i = x * 8;
+            int r = (row0[i] + row0[i + 4] + row1[i] + row1[i + 4]) >> 2;
+            int g = (row0[i + 1] + row0[i + 5] + row1[i + 1] + row1[i + 5]) >> 2;
+            int b = (row0[i + 2] + row0[i + 6] + row1[i + 2] + row1[i + 6]) >> 2;
+            uPlane[y * (WIDTH / 2) + x] = (Uint8)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            vPlane[y * (WIDTH / 2) + x] = (Uint8)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+}
+
+// Writer thread: encodes queued frames to Y4M and hands the buffers back
+int exportWriter(void *data) {
+    (void)data;
+    Uint8 *yuv = malloc(WIDTH * HEIGHT * 3 / 2);
+    if (!yuv) {
+        fprintf(stderr, "Out of memory for the export writer\n");
+    }
+
+    for (;;) {
+        SDL_LockMutex(exporter.lock);
+        if (!yuv) exporter.failed = 1;
+        while (exporter.queueCount == 0 && !exporter.done) {
+            SDL_CondWait(exporter.frameQueued, exporter.lock);
+        }
+        if (exporter.queueCount == 0) {  // Done and fully drained
+            SDL_UnlockMutex(exporter.lock);
+            break;
+        }
+        int buffer = exporter.queue[exporter.queueHead];
+        exporter.queueHead = (exporter.queueHead + 1) % EXPORT_POOL_SIZE;
+        exporter.queueCount--;
+        int failed = exporter.failed;
+        SDL_UnlockMutex(exporter.lock);
+
+        // After a failure keep handing buffers back so the renderer never blocks forever
+        if (!failed) {
+            convertFrameToI420(exporter.pixels[buffer], yuv);
+            if (fputs("FRAME\n", exporter.out) == EOF ||
+                fwrite(yuv, 1, WIDTH * HEIGHT * 3 / 2, exporter.out) != WIDTH * HEIGHT * 3 / 2) {
+                perror("Writing export frame");
+                failed = 1;
+            }
+        }
+
+        SDL_LockMutex(exporter.lock);
+        exporter.failed |= failed;
+        exporter.freeBuffers[exporter.numFree++] = buffer;
+        SDL_CondSignal(exporter.bufferFreed);
+        SDL_UnlockMutex(exporter.lock);
+    }
+
+    free(yuv);
+    return 0;
+}
+
+// Release whatever startExport() managed to set up
+void cleanupExport() {
+    for (int i = 0; i < EXPORT_POOL_SIZE; i++) {
+        free(exporter.pixels[i]);
+        exporter.pixels[i] = NULL;
+    }
+    if (exporter.frameQueued) SDL_DestroyCond(exporter.frameQueued);
+    if (exporter.bufferFreed) SDL_DestroyCond(exporter.bufferFreed);
+    if (exporter.lock) SDL_DestroyMutex(exporter.lock);
+    exporter.frameQueued = exporter.bufferFreed = NULL;
+    exporter.lock = NULL;
+
+    if (exporter.target) {
+        SDL_SetRenderTarget(renderer, NULL);
+        SDL_DestroyTexture(exporter.target);
+        exporter.target = NULL;
+    }
+    exporter.active = 0;
+}
+
+int startExport(const char *path, int numFrames) {
+    exporter.out = fopen(path, "wb");
+    if (!exporter.out) {
+        perror(path);
+        return 0;
+    }
+    if (fprintf(exporter.out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", WIDTH, HEIGHT, FPS) < 0) {
+        perror(path);
+        fclose(exporter.out);
+        return 0;
+    }
+
+    exporter.target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, WIDTH, HEIGHT);
+    if (!exporter.target || SDL_SetRenderTarget(renderer, exporter.target) != 0) {
+        fprintf(stderr, "Cannot create offscreen target: %s\n", SDL_GetError());
+        cleanupExport();
+        fclose(exporter.out);
+        return 0;
+    }
+
+    for (int i = 0; i < EXPORT_POOL_SIZE; i++) {
+        exporter.pixels[i] = malloc(WIDTH * HEIGHT * 4);
+        if (!exporter.pixels[i]) {
+            fprintf(stderr, "Out of memory for export frame buffers\n");
+            cleanupExport();
+            fclose(exporter.out);
+            return 0;
+        }
+        exporter.freeBuffers[i] = i;
+    }
+    exporter.numFree = EXPORT_POOL_SIZE;
+    exporter.queueHead = exporter.queueCount = 0;
+    exporter.done = 0;
+    exporter.failed = 0;
+
+    exporter.lock = SDL_CreateMutex();
+    exporter.frameQueued = SDL_CreateCond();
+    exporter.bufferFreed = SDL_CreateCond();
+    exporter.writer = NULL;
+    if (exporter.lock && exporter.frameQueued && exporter.bufferFreed) {
+        exporter.writer = SDL_CreateThread(exportWriter, "exportWriter", NULL);
+    }
+    if (!exporter.writer) {
+        fprintf(stderr, "Cannot start the export writer: %s\n", SDL_GetError());
+        cleanupExport();
+        fclose(exporter.out);
+        return 0;
+    }
+
+    exporter.frame = 0;
+    exporter.numFrames = numFrames;
+    exporter.active = 1;
+    return 1;
+}
+
+// Read the finished frame back into a pooled buffer and queue it for the writer.
+// Only waits when every buffer is still queued, i.e. the writer has fallen behind.
+// Returns 0 once the export has failed.
+int captureFrame() {
+    SDL_LockMutex(exporter.lock);
+    while (exporter.numFree == 0) {
+        SDL_CondWait(exporter.bufferFreed, exporter.lock);
+    }
+    int buffer = exporter.freeBuffers[--exporter.numFree];
+    int failed = exporter.failed;
+    SDL_UnlockMutex(exporter.lock);
+
+    if (!failed && SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_RGBA32, exporter.pixels[buffer], WIDTH * 4) != 0) {
+        fprintf(stderr, "Cannot read back frame %d: %s\n", exporter.frame, SDL_GetError());
+        failed = 1;
+    }
+
+    SDL_LockMutex(exporter.lock);
+    if (failed) {
+        exporter.failed = 1;
+        exporter.freeBuffers[exporter.numFree++] = buffer;
+    } else {
+        exporter.queue[(exporter.queueHead + exporter.queueCount) % EXPORT_POOL_SIZE] = buffer;
+        exporter.queueCount++;
+        SDL_CondSignal(exporter.frameQueued);
+    }
+    SDL_UnlockMutex(exporter.lock);
+    return !failed;
+}
+
+// Drain the queue, stop the writer and close the file; returns 0 if anything failed
+int finishExport() {
+    SDL_LockMutex(exporter.lock);
+    exporter.done = 1;
+    SDL_CondSignal(exporter.frameQueued);
+    SDL_UnlockMutex(exporter.lock);
+    SDL_WaitThread(exporter.writer, NULL);
+
+    int ok = !exporter.failed;
+    cleanupExport();
+    if (fclose(exporter.out) != 0) {
+        perror("Closing export file");
+        ok = 0;
+    }
+    return ok;
+}
+
+// Scripted mouse path for exports: a slow figure-eight over the meadow
+void exportMouse(int frame, int *mouseX, int *mouseY) {
+    float t = frame / (float)FPS;
+    *mouseX = WIDTH / 2 + (int)(cos(t * 0.5f) * (WIDTH / 2 - 60));
+    *mouseY = HEIGHT / 2 + (int)(sin(t * 1.0f) * (HEIGHT / 2 - 60));
+}
+
+// Play the game headlessly as fast as possible, streaming every frame to the writer.
+// Returns 0 on failure.
+int runExport(const char *path, int numFrames) {
+    if (!startExport(path, numFrames)) return 0;
+
+    Uint32 exportStart = SDL_GetTicks();
+    inGame = 1;
+    initDrones();
+
+    for (; exporter.frame < exporter.numFrames && running; exporter.frame++) {
+        SDL_Event e;
+        while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_QUIT) running = 0;
+        }
+
+        // Keep the clip going through deaths
+        if (gameOver) {
+            gameOver = 0;
+            inGame = 1;
+            initDrones();
+        }
+
+        int mouseX, mouseY;
+        exportMouse(exporter.frame, &mouseX, &mouseY);
+        updatePlayer(NULL, mouseX, mouseY);
+        renderGame();
+        if (!captureFrame()) break;
+    }
+
+    int framesWritten = exporter.frame;
+    if (!finishExport()) {
+        fprintf(stderr, "Export to %s failed after %d frames\n", path, framesWritten);
+        return 0;
+    }
+
+    Uint32 elapsed = SDL_GetTicks() - exportStart;
+    Uint32 clipLength = (Uint32)((Uint64)framesWritten * 1000 / FPS);
+    printf("Exported %d frames (%u ms of video) to %s in %u ms, %.1fx real time\n",
+           framesWritten, clipLength, path, elapsed, elapsed > 0 ? clipLength / (double)elapsed : 0.0);
+    return 1;
+}
+
 // Main loop
 int main(int argc, char* argv[]) {
+    const char *exportPath = NULL;
+    int exportFrames = EXPORT_SECONDS * FPS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--hunt") == 0) {
+            huntMode = 1;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            profileMode = 1;
+        } else if (strcmp(argv[i], "--stress-particles") == 0) {
+            stressParticles = 1;
+        } else if (strcmp(argv[i], "--export") == 0 && i + 1 < argc) {
+            exportPath = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            exportFrames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            gameSeed = (unsigned int)strtoul(argv[++i], NULL, 10);
+            useSeed = 1;
+        }
+    }
+
+    if (exportPath) {
+        // No screen needed; respect an explicitly chosen driver though
+        SDL_setenv("SDL_VIDEODRIVER", "offscreen", 0);
+    }
+
     SDL_Init(SDL_INIT_VIDEO);
     TTF_Init();
+    // Not SDL_WINDOW_HIDDEN when exporting: SDL skips all drawing for renderers of
+    // hidden windows, even into a target texture. The offscreen driver shows nothing anyway.
     window = SDL_CreateWindow("Drone Zone", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, WIDTH, HEIGHT, 0);
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    renderer = SDL_CreateRenderer(window, -1, exportPath ? SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE : SDL_RENDERER_ACCELERATED);
     font = TTF_OpenFont("Sigmar-Regular.ttf", 24);
 
+    if (exportPath) {
+        int ok = window && renderer && font && runExport(exportPath, exportFrames);
+        if (!window || !renderer || !font) {
+            fprintf(stderr, "Cannot set up headless rendering: %s\n", SDL_GetError());
+        }
+        if (renderer) SDL_DestroyRenderer(renderer);
+        if (window) SDL_DestroyWindow(window);
+        TTF_Quit();
+        SDL_Quit();
+        return ok ? 0 : 1;
+    }
+
     loadHighScore();
     renderMenu();
 
@@ -766,7 +1901,6 @@ int main(int argc, char* argv[]) {
             renderMenu(); // Main menu
         } else if (inGame) {
             updatePlayer(NULL, mouseX, mouseY);
-            checkCollisions();
             renderGame(); // In-game rendering
         }        
 